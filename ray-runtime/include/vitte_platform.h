@@ -77,6 +77,7 @@ typedef int32_t vitte_status_t;
 #define VITTE_EIO ((vitte_status_t) - 5)
 #define VITTE_EAGAIN ((vitte_status_t) - 11)
 #define VITTE_EOVERFLOW ((vitte_status_t) - 75)
+#define VITTE_EALREADY ((vitte_status_t) - 114)
 
 /* Networking / IO common */
 #define VITTE_ECONNRESET ((vitte_status_t) - 104)
@@ -161,6 +162,8 @@ typedef struct vitte_platform_info {
 #define VITTE_FEAT0_HAS_FUTEX (1ull << 7)
 #define VITTE_FEAT0_HAS_EVENTFD (1ull << 8)
 #define VITTE_FEAT0_HAS_TIMERFD (1ull << 9)
+#define VITTE_FEAT0_HAS_SSE2 (1ull << 10) /* x86_64 CPU (cpuid) */
+#define VITTE_FEAT0_HAS_AVX2 (1ull << 11) /* cpuid + OS saves ymm (xgetbv) */
 
 /* ----------------------------------------------------------------------------
  * Time / clocks
@@ -207,15 +210,50 @@ typedef struct vitte_thread_start {
   void (*entry)(void* user);
   void* user;
   uint32_t stack_size; /* 0 => default */
-  uint32_t flags;      /* reserved */
+  uint32_t flags;      /* VITTE_THREAD_* */
+  void* stack;         /* VITTE_THREAD_USER_STACK: lowest address */
+  uint32_t cpu;        /* VITTE_THREAD_PIN: OS CPU id */
+  uint32_t _pad0;
 } vitte_thread_start;
 
+/* Run on a caller-provided stack of stack_size bytes (guard page
+ * included). The caller keeps ownership; it must outlive the thread. */
+#define VITTE_THREAD_USER_STACK (1u << 0)
+/* Pin the new thread to `cpu` before its entry runs. */
+#define VITTE_THREAD_PIN (1u << 1)
+
 VITTE_PLAT_API vitte_status_t vitte_thread_spawn(
     const vitte_thread_start* start, vitte_thread_handle* out_th);
 VITTE_PLAT_API vitte_status_t vitte_thread_join(vitte_thread_handle th);
 VITTE_PLAT_API vitte_status_t vitte_thread_detach(vitte_thread_handle th);
 VITTE_PLAT_API vitte_status_t vitte_thread_yield(void);
 VITTE_PLAT_API vitte_status_t vitte_thread_current_id(uint64_t* out_tid);
+/* Pin the calling thread to one CPU. */
+VITTE_PLAT_API vitte_status_t vitte_thread_pin(uint32_t cpu);
+
+/* ----------------------------------------------------------------------------
+ * CPU topology / NUMA
+ * ----------------------------------------------------------------------------
+ */
+typedef struct vitte_cpu_desc {
+  uint32_t cpu;   /* OS CPU id */
+  uint32_t core;  /* physical core id; SMT siblings share it */
+  uint32_t node;  /* NUMA node, 0 without NUMA */
+  uint32_t flags; /* reserved */
+} vitte_cpu_desc;
+
+/* CPUs this process may run on (affinity mask), in OS order. Writes
+ * min(cap, n) entries and sets *out_n = n. */
+VITTE_PLAT_API vitte_status_t vitte_cpu_topology(vitte_cpu_desc* out,
+                                                 uint32_t cap,
+                                                 uint32_t* out_n);
+/* CPU and NUMA node the calling thread runs on (getcpu). */
+VITTE_PLAT_API vitte_status_t vitte_current_cpu(uint32_t* out_cpu,
+                                                uint32_t* out_node);
+/* Preferred NUMA node for [addr, addr+len) (page aligned), to be set
+ * before the pages are first touched. ENOSYS without NUMA support. */
+VITTE_PLAT_API vitte_status_t vitte_mem_bind_node(void* addr, size_t len,
+                                                  uint32_t node);
 
 /* ----------------------------------------------------------------------------
  * Futex / wait-wake (best-effort abstraction)
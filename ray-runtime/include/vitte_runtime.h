@@ -68,6 +68,21 @@ typedef uint64_t vitte_rt_features;
 #define VITTE_RT_FEAT_PROCESS (1ull << 4)
 #define VITTE_RT_FEAT_SIGNAL (1ull << 5)
 #define VITTE_RT_FEAT_PLUGINS (1ull << 6)
+/* io_uring completion backend (Linux); falls back to epoll if unavailable */
+#define VITTE_RT_FEAT_IO_URING (1ull << 7)
+/* per-worker scheduling trace rings (flight recorder, ~1 MiB per worker) */
+#define VITTE_RT_FEAT_TRACING (1ull << 8)
+/* clocked per-worker histograms: poll duration, schedule-to-run latency */
+#define VITTE_RT_FEAT_METRICS (1ull << 9)
+/* pin worker i to a CPU: one per physical core first, then SMT siblings */
+#define VITTE_RT_FEAT_PIN_WORKERS (1ull << 10)
+/* pinned workers alternate NUMA nodes (implies PIN_WORKERS) */
+#define VITTE_RT_FEAT_PIN_SPREAD (1ull << 11)
+/* thread-per-core: pinned workers, no work stealing, per-worker local
+ * sets (spawn / wake without atomics) */
+#define VITTE_RT_FEAT_THREAD_PER_CORE (1ull << 12)
+/* allocator magazines and arena chunks from the worker's NUMA node */
+#define VITTE_RT_FEAT_NUMA_LOCAL (1ull << 13)
 
 #define VITTE_RT_FEAT_DEFAULT                                          \
   (VITTE_RT_FEAT_ASYNC_IO | VITTE_RT_FEAT_TIMERS | VITTE_RT_FEAT_NET | \
@@ -82,10 +97,10 @@ typedef struct vitte_runtime_config {
   uint32_t struct_size; /* sizeof(vitte_runtime_config) */
 
   uint32_t workers;          /* 0 => auto */
-  uint32_t blocking_threads; /* 0 => auto/disabled */
+  uint32_t blocking_threads; /* cap of the elastic blocking pool, 0 => 512 */
 
   uint32_t stack_size;     /* 0 => default */
-  uint32_t queue_capacity; /* 0 => default */
+  uint32_t queue_capacity; /* per-worker run queue; 0 => default (256) */
 
   vitte_rt_features features; /* bitmask */
 
@@ -144,14 +159,19 @@ typedef struct vitte_spawn_opts {
   uint32_t api_version;
   uint32_t struct_size;
 
-  uint32_t flags;    /* reserved */
+  uint32_t flags;    /* VITTE_SPAWN_* */
   uint32_t priority; /* reserved */
-  uint64_t budget;   /* cooperative budget (ticks) */
+  uint64_t budget;   /* I/O operations per poll before a forced yield;
+                        0 => runtime default (128) */
 
   uint64_t reserved0;
 } vitte_spawn_opts;
 
 #define VITTE_SPAWN_DETACHED (1u << 0)
+/* Future/combinator state of the task comes from a task-scoped bump arena,
+   released in one shot when the task completes or is cancelled. Such state
+   must not outlive the task. */
+#define VITTE_SPAWN_ARENA (1u << 1)
 
 VITTE_PLAT_INLINE vitte_spawn_opts vitte_spawn_opts_default(void) {
   vitte_spawn_opts o;
@@ -170,10 +190,30 @@ VITTE_PLAT_API vitte_status_t vitte_task_spawn(vitte_runtime_handle rt,
                                                vitte_task_fn fn, void* user,
                                                vitte_task_handle* out_task);
 
+/* One entry of a batched spawn. opts may be NULL (defaults). */
+typedef struct vitte_spawn_batch_entry {
+  vitte_task_fn fn;
+  void* user;
+  const vitte_spawn_opts* opts;
+} vitte_spawn_batch_entry;
+
+/* Spawn `count` tasks in one call (one allocation, one queue push).
+ * out_tasks[i] receives the handle of entries[i] (0 if DETACHED); it may be
+ * NULL only if every entry is DETACHED. All-or-nothing: on error no task of
+ * the batch is scheduled. */
+VITTE_PLAT_API vitte_status_t vitte_task_spawn_batch(
+    vitte_runtime_handle rt, const vitte_spawn_batch_entry* entries,
+    uint64_t count, vitte_task_handle* out_tasks);
+
+/* Request cancellation. A task that has not started completes as canceled
+ * without running; a running task sees the request at its next scheduling
+ * point. The handle stays joinable. VITTE_EALREADY if the task had already
+ * completed, VITTE_EINVAL for an unknown or already joined handle. */
 VITTE_PLAT_API vitte_status_t vitte_task_cancel(vitte_runtime_handle rt,
                                                 vitte_task_handle task);
 
-/* Join task and get result. */
+/* Join task and get result. Consumes the handle: a second join (or any
+ * later use) returns VITTE_EINVAL. */
 VITTE_PLAT_API vitte_status_t vitte_task_join(vitte_runtime_handle rt,
                                               vitte_task_handle task,
                                               vitte_task_result* out_res);
@@ -276,10 +316,94 @@ VITTE_PLAT_API vitte_io_rw_result vitte_tcp_write(vitte_runtime_handle rt,
                                                   vitte_io_handle stream,
                                                   vitte_io_buf buf);
 
+/* Vectored I/O: one readv/writev over `count` buffers (<= 1024 per call;
+ * vitte_io_buf has the struct iovec layout). Partial results possible. */
+VITTE_PLAT_API vitte_io_rw_result vitte_tcp_readv(vitte_runtime_handle rt,
+                                                  vitte_io_handle stream,
+                                                  const vitte_io_buf* bufs,
+                                                  uint32_t count);
+VITTE_PLAT_API vitte_io_rw_result vitte_tcp_writev(vitte_runtime_handle rt,
+                                                   vitte_io_handle stream,
+                                                   const vitte_io_buf* bufs,
+                                                   uint32_t count);
+
+/* Zero-copy: file -> socket (sendfile; `file` is a raw file descriptor),
+ * socket -> socket (splice through a pipe). n < len only at EOF.
+ * -EOPNOTSUPP (-95) when the kernel refuses the descriptors. */
+VITTE_PLAT_API vitte_io_rw_result vitte_tcp_sendfile(vitte_runtime_handle rt,
+                                                     vitte_io_handle stream,
+                                                     vitte_handle_u64 file,
+                                                     uint64_t offset,
+                                                     uint64_t len);
+VITTE_PLAT_API vitte_io_rw_result vitte_tcp_splice(vitte_runtime_handle rt,
+                                                   vitte_io_handle from,
+                                                   vitte_io_handle to,
+                                                   uint64_t len);
+
 VITTE_PLAT_API vitte_status_t vitte_tcp_set_nodelay(vitte_runtime_handle rt,
                                                     vitte_io_handle stream,
                                                     int32_t enabled);
 
+/* ----------------------------------------------------------------------------
+ * UDP — closed with vitte_io_close
+ * ----------------------------------------------------------------------------
+ */
+typedef struct vitte_udp_bind_req {
+  uint32_t api_version;
+  uint32_t struct_size;
+  vitte_sockaddr addr; /* port 0 => ephemeral */
+  uint32_t flags;
+  uint32_t _pad;
+} vitte_udp_bind_req;
+
+#define VITTE_UDP_META_TRUNCATED (1u << 0) /* datagram larger than buffer */
+
+typedef struct vitte_udp_recv_meta {
+  uint64_t len;        /* bytes written to the buffer */
+  vitte_sockaddr from;
+  uint32_t segment;    /* GRO: size of each coalesced datagram, 0 = one */
+  uint32_t flags;      /* VITTE_UDP_META_* */
+} vitte_udp_recv_meta;
+
+VITTE_PLAT_API vitte_status_t vitte_udp_bind(vitte_runtime_handle rt,
+                                             const vitte_udp_bind_req* req,
+                                             vitte_io_handle* out_sock);
+/* Default peer for send (to == NULL) / recv; other sources are dropped. */
+VITTE_PLAT_API vitte_status_t vitte_udp_connect(vitte_runtime_handle rt,
+                                                vitte_io_handle sock,
+                                                const vitte_sockaddr* addr);
+
+VITTE_PLAT_API vitte_io_rw_result vitte_udp_send_to(vitte_runtime_handle rt,
+                                                    vitte_io_handle sock,
+                                                    vitte_io_buf buf,
+                                                    const vitte_sockaddr* to);
+VITTE_PLAT_API vitte_io_rw_result
+vitte_udp_recv_from(vitte_runtime_handle rt, vitte_io_handle sock,
+                    vitte_io_buf buf, vitte_sockaddr* out_from);
+
+/* Batches: one sendmmsg / recvmmsg per call (<= 1024 datagrams). n counts
+ * datagrams, not bytes. send: `to` is NULL (connected) or holds `count`
+ * addresses; loops until all are sent or an error (n = sent so far).
+ * recv: waits for the first datagram, then takes what is queued;
+ * metas[i] describes bufs[i]. */
+VITTE_PLAT_API vitte_io_rw_result
+vitte_udp_send_batch(vitte_runtime_handle rt, vitte_io_handle sock,
+                     const vitte_io_buf* bufs, const vitte_sockaddr* to,
+                     uint32_t count);
+VITTE_PLAT_API vitte_io_rw_result
+vitte_udp_recv_batch(vitte_runtime_handle rt, vitte_io_handle sock,
+                     const vitte_io_buf* bufs, vitte_udp_recv_meta* metas,
+                     uint32_t count);
+
+/* GSO (UDP_SEGMENT): sends larger than `size` leave as `size`-byte
+ * datagrams (<= 64 per send), 0 = off. GRO (UDP_GRO): see
+ * vitte_udp_recv_meta.segment. -EOPNOTSUPP (-95) without kernel support. */
+VITTE_PLAT_API vitte_status_t vitte_udp_set_segment_size(
+    vitte_runtime_handle rt, vitte_io_handle sock, uint32_t size);
+VITTE_PLAT_API vitte_status_t vitte_udp_set_gro(vitte_runtime_handle rt,
+                                                vitte_io_handle sock,
+                                                int32_t enabled);
+
 /* ----------------------------------------------------------------------------
  * Plugins (optional) — host side; you can split to vitte_plugin.h
  * ----------------------------------------------------------------------------
@@ -327,6 +451,61 @@ typedef struct vitte_rt_counters {
 VITTE_PLAT_API vitte_status_t vitte_runtime_counters(
     vitte_runtime_handle rt, vitte_rt_counters* out_counters);
 
+/* Histogram summary; quantiles are bucket lower bounds (<= 1/16 error). */
+typedef struct vitte_rt_hist_summary {
+  uint64_t count;
+  uint64_t sum;
+  uint64_t max;
+  uint64_t p50;
+  uint64_t p90;
+  uint64_t p99;
+  uint64_t p999;
+} vitte_rt_hist_summary;
+
+#define VITTE_RT_COUNTERS_V2 2u
+#define VITTE_RT_ALL_WORKERS 0xFFFFFFFFu
+
+/* Per-worker shards, merged on read. Set api_version, struct_size and
+ * worker (index or VITTE_RT_ALL_WORKERS); at most struct_size bytes are
+ * written and struct_size is set to the bytes written. Fields are only
+ * ever appended. */
+typedef struct vitte_rt_counters_v2 {
+  uint32_t api_version; /* in: VITTE_RT_COUNTERS_V2 */
+  uint32_t struct_size; /* in: sizeof; out: bytes written */
+  uint32_t worker;      /* in */
+  uint32_t workers;     /* out */
+
+  /* runtime-wide, as in v1 */
+  uint64_t tasks_spawned;
+  uint64_t tasks_completed;
+  uint64_t timers_created;
+  uint64_t io_handles;
+
+  /* selected shard(s) */
+  uint64_t polls;
+  uint64_t polls_ready;
+  uint64_t steal_attempts;
+  uint64_t steal_successes;
+  uint64_t overflows;
+  uint64_t parks;
+  uint64_t unparks; /* parks ended by unpark rather than timeout */
+  uint64_t reactor_turns;
+  uint64_t reactor_events;
+
+  vitte_rt_hist_summary queue_depth;      /* sampled every 61 polls */
+  vitte_rt_hist_summary poll_ns;          /* VITTE_RT_FEAT_METRICS */
+  vitte_rt_hist_summary sched_latency_ns; /* VITTE_RT_FEAT_METRICS */
+  vitte_rt_hist_summary events_per_turn;
+
+  /* cooperative budgets */
+  uint64_t yields;        /* yield points that ran other work (shard) */
+  uint64_t forced_yields; /* poll budget exhausted (shard) */
+  uint64_t slow_polls;    /* runtime-wide, flagged by the poll watchdog */
+} vitte_rt_counters_v2;
+
+VITTE_PLAT_API vitte_status_t vitte_runtime_counters_v2(
+    vitte_runtime_handle rt, vitte_rt_counters_v2* inout_counters);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
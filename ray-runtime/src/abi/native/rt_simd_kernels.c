@@ -0,0 +1,370 @@
+/* ray-runtime/src/abi/native/rt_simd_kernels.c
+ * ============================================================================
+ * rt_simd_kernels.c — Kernels natifs SSE2 / AVX2 (abi_strings, abi_stable_hash)
+ *
+ * Objectifs:
+ *   - rt_utf8_validate_sse2 / _avx2 : validation UTF-8 stricte, même verdict
+ *     que abi_strings.utf8_is_valid_scalar pour toute entrée
+ *       * sse2 : blocs de 16 o ASCII sautés sur movemask, séquences
+ *                multi-octets décodées une à une (pas de pshufb en SSE2)
+ *       * avx2 : algorithme par tables (Keiser-Lemire): 3 vpshufb sur les
+ *                quartets des octets n-1 / n, contrôle des 3e / 4e octets
+ *                par soustraction saturée; blocs ASCII sautés
+ *   - rt_hash_stripes_sse2 / _avx2 : bandes de 64 o de abi_stable_hash,
+ *     au bit près comme _stripes_scalar (_mm_mul_epu32 + échange de voies)
+ *   - rt_simd_level_slot : cellule u32 du niveau SIMD mis en cache par
+ *     plat_detect.simd_level() (dispatch)
+ *
+ * Notes:
+ *   - Une seule unité, compilée avec les flags de base: les fonctions AVX2
+ *     portent __attribute__((target("avx2"))) (GCC / Clang); le dispatch
+ *     Vitte ne les appelle qu'à pdet.simd_level() >= SIMD_AVX2.
+ *   - Aucune lecture hors de [p, p+n): la queue est recopiée dans un bloc
+ *     local complété par des zéros (un zéro après une séquence tronquée
+ *     est une erreur TOO_SHORT, la fin de chaîne est donc vérifiée).
+ *   - Hors x86_64: mêmes symboles en C scalaire (jamais appelés: le niveau
+ *     reste SIMD_SCALAR), pour que l'édition de liens passe partout.
+ * ============================================================================
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define RT_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define RT_SIMD_X86 0
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define RT_TARGET_AVX2 __attribute__((target("avx2")))
+#define RT_CTZ32(x) ((uint32_t)__builtin_ctz(x))
+#else
+#define RT_TARGET_AVX2
+static uint32_t rt_ctz32_(uint32_t x) {
+  uint32_t n = 0;
+  while ((x & 1u) == 0) {
+    x >>= 1;
+    n++;
+  }
+  return n;
+}
+#define RT_CTZ32(x) rt_ctz32_(x)
+#endif
+
+/* ----------------------------------------------------------------------------
+ * Dispatch
+ * ----------------------------------------------------------------------------
+ */
+
+/* Niveau + 1 (0: pas encore détecté), lu / écrit atomiquement côté Vitte. */
+static uint32_t rt_simd_level_cell;
+
+uintptr_t rt_simd_level_slot(void) {
+  return (uintptr_t)&rt_simd_level_cell;
+}
+
+/* ----------------------------------------------------------------------------
+ * UTF-8: décodage d'une séquence (miroir de abi_strings._utf8_seq)
+ * ----------------------------------------------------------------------------
+ */
+
+static int rt_cont(uint8_t b) {
+  return (b & 0xC0) == 0x80;
+}
+
+/* Longueur de la séquence bien formée menée par p[i] (>= 0x80), 0 sinon. */
+static size_t rt_utf8_seq(const uint8_t *p, size_t n, size_t i) {
+  uint8_t b0 = p[i];
+  if (b0 < 0xC2) {
+    return 0;
+  }
+  if (b0 < 0xE0) {
+    return (i + 1 < n && rt_cont(p[i + 1])) ? 2 : 0;
+  }
+  if (b0 < 0xF0) {
+    if (i + 2 >= n) {
+      return 0;
+    }
+    uint8_t b1 = p[i + 1];
+    if (!rt_cont(b1) || !rt_cont(p[i + 2])) {
+      return 0;
+    }
+    if ((b0 == 0xE0 && b1 < 0xA0) || (b0 == 0xED && b1 >= 0xA0)) {
+      return 0;
+    }
+    return 3;
+  }
+  if (b0 < 0xF5) {
+    if (i + 3 >= n) {
+      return 0;
+    }
+    uint8_t b1 = p[i + 1];
+    if (!rt_cont(b1) || !rt_cont(p[i + 2]) || !rt_cont(p[i + 3])) {
+      return 0;
+    }
+    if ((b0 == 0xF0 && b1 < 0x90) || (b0 == 0xF4 && b1 > 0x8F)) {
+      return 0;
+    }
+    return 4;
+  }
+  return 0;
+}
+
+#define RT_STRIPE 64 /* octets par bande (abi_stable_hash.STRIPE) */
+
+#if RT_SIMD_X86
+
+/* ----------------------------------------------------------------------------
+ * SSE2
+ * ----------------------------------------------------------------------------
+ */
+
+uint32_t rt_utf8_validate_sse2(uintptr_t ptr, size_t n) {
+  const uint8_t *p = (const uint8_t *)ptr;
+  size_t i = 0;
+  while (i < n) {
+    while (i + 16 <= n) {
+      uint32_t m = (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)(p + i)));
+      if (m == 0) {
+        i += 16;
+        continue;
+      }
+      i += RT_CTZ32(m);
+      break;
+    }
+    if (i >= n) {
+      break;
+    }
+    if (p[i] < 0x80) {
+      i++;
+      continue;
+    }
+    /* Séquences en rafale: reste sur le chemin scalaire tant que le texte
+     * n'est pas ASCII. */
+    while (i < n && p[i] >= 0x80) {
+      size_t k = rt_utf8_seq(p, n, i);
+      if (k == 0) {
+        return 0;
+      }
+      i += k;
+    }
+  }
+  return 1;
+}
+
+/* acc[i] += lo32(dk) * hi32(dk); acc[i ^ 1] += d (voies échangées dans la
+ * paire 64 bits). */
+void rt_hash_stripes_sse2(uintptr_t acc_p, uintptr_t p, size_t stripes, uintptr_t keys_p) {
+  uint64_t *acc = (uint64_t *)acc_p;
+  const uint8_t *in = (const uint8_t *)p;
+  const uint64_t *keys = (const uint64_t *)keys_p;
+  __m128i a[4];
+  __m128i k[4];
+  for (int j = 0; j < 4; j++) {
+    a[j] = _mm_loadu_si128((const __m128i *)(acc + 2 * j));
+    k[j] = _mm_loadu_si128((const __m128i *)(keys + 2 * j));
+  }
+  for (size_t s = 0; s < stripes; s++) {
+    const uint8_t *b = in + s * RT_STRIPE;
+    for (int j = 0; j < 4; j++) {
+      __m128i d = _mm_loadu_si128((const __m128i *)(b + 16 * j));
+      __m128i dk = _mm_xor_si128(d, k[j]);
+      __m128i prod = _mm_mul_epu32(dk, _mm_srli_epi64(dk, 32));
+      __m128i swap = _mm_shuffle_epi32(d, _MM_SHUFFLE(1, 0, 3, 2));
+      a[j] = _mm_add_epi64(a[j], _mm_add_epi64(prod, swap));
+    }
+  }
+  for (int j = 0; j < 4; j++) {
+    _mm_storeu_si128((__m128i *)(acc + 2 * j), a[j]);
+  }
+}
+
+/* ----------------------------------------------------------------------------
+ * AVX2
+ * ----------------------------------------------------------------------------
+ */
+
+/* Erreurs par paire d'octets (prev1, input). */
+#define U8_TOO_SHORT (1 << 0)  /* 11______ 0_______ / 11______ 11______ */
+#define U8_TOO_LONG (1 << 1)   /* 0_______ 10______ */
+#define U8_OVERLONG_3 (1 << 2) /* 11100000 100_____ */
+#define U8_TOO_LARGE (1 << 3)  /* 11110100 1001____ / 11110100 101_____ */
+#define U8_SURROGATE (1 << 4)  /* 11101101 101_____ */
+#define U8_OVERLONG_2 (1 << 5) /* 1100000_ 10______ */
+#define U8_TOO_LARGE_1000 (1 << 6) /* 11110101+ 1000____ */
+#define U8_OVERLONG_4 (1 << 6)     /* 11110000 1000____ */
+#define U8_TWO_CONTS (1 << 7)      /* 10______ 10______ */
+#define U8_CARRY (U8_TOO_SHORT | U8_TOO_LONG | U8_TWO_CONTS)
+
+#define RT_LUT16(...) _mm256_setr_epi8(__VA_ARGS__, __VA_ARGS__)
+
+/* Octets [i - n] de input pour chaque i, pris dans prev au début du bloc. */
+#define RT_PREV(input, prev, nb) \
+  _mm256_alignr_epi8((input), _mm256_permute2x128_si256((prev), (input), 0x21), 16 - (nb))
+
+RT_TARGET_AVX2 static __m256i rt_u8_check(__m256i input, __m256i prev) {
+  const __m256i lo4 = _mm256_set1_epi8(0x0F);
+  const __m256i b1_high_lut = RT_LUT16(
+      U8_TOO_LONG, U8_TOO_LONG, U8_TOO_LONG, U8_TOO_LONG,
+      U8_TOO_LONG, U8_TOO_LONG, U8_TOO_LONG, U8_TOO_LONG,
+      U8_TWO_CONTS, U8_TWO_CONTS, U8_TWO_CONTS, U8_TWO_CONTS,
+      U8_TOO_SHORT | U8_OVERLONG_2,
+      U8_TOO_SHORT,
+      U8_TOO_SHORT | U8_OVERLONG_3 | U8_SURROGATE,
+      U8_TOO_SHORT | U8_TOO_LARGE | U8_TOO_LARGE_1000 | U8_OVERLONG_4);
+  const __m256i b1_low_lut = RT_LUT16(
+      U8_CARRY | U8_OVERLONG_3 | U8_OVERLONG_2 | U8_OVERLONG_4,
+      U8_CARRY | U8_OVERLONG_2,
+      U8_CARRY,
+      U8_CARRY,
+      U8_CARRY | U8_TOO_LARGE,
+      U8_CARRY | U8_TOO_LARGE | U8_TOO_LARGE_1000,
+      U8_CARRY | U8_TOO_LARGE | U8_TOO_LARGE_1000,
+      U8_CARRY | U8_TOO_LARGE | U8_TOO_LARGE_1000,
+      U8_CARRY | U8_TOO_LARGE | U8_TOO_LARGE_1000,
+      U8_CARRY | U8_TOO_LARGE | U8_TOO_LARGE_1000,
+      U8_CARRY | U8_TOO_LARGE | U8_TOO_LARGE_1000,
+      U8_CARRY | U8_TOO_LARGE | U8_TOO_LARGE_1000,
+      U8_CARRY | U8_TOO_LARGE | U8_TOO_LARGE_1000,
+      U8_CARRY | U8_TOO_LARGE | U8_TOO_LARGE_1000 | U8_SURROGATE,
+      U8_CARRY | U8_TOO_LARGE | U8_TOO_LARGE_1000,
+      U8_CARRY | U8_TOO_LARGE | U8_TOO_LARGE_1000);
+  const __m256i b2_high_lut = RT_LUT16(
+      U8_TOO_SHORT, U8_TOO_SHORT, U8_TOO_SHORT, U8_TOO_SHORT,
+      U8_TOO_SHORT, U8_TOO_SHORT, U8_TOO_SHORT, U8_TOO_SHORT,
+      U8_TOO_LONG | U8_OVERLONG_2 | U8_TWO_CONTS | U8_OVERLONG_3 | U8_TOO_LARGE_1000 | U8_OVERLONG_4,
+      U8_TOO_LONG | U8_OVERLONG_2 | U8_TWO_CONTS | U8_OVERLONG_3 | U8_TOO_LARGE,
+      U8_TOO_LONG | U8_OVERLONG_2 | U8_TWO_CONTS | U8_SURROGATE | U8_TOO_LARGE,
+      U8_TOO_LONG | U8_OVERLONG_2 | U8_TWO_CONTS | U8_SURROGATE | U8_TOO_LARGE,
+      U8_TOO_SHORT, U8_TOO_SHORT, U8_TOO_SHORT, U8_TOO_SHORT);
+
+  __m256i prev1 = RT_PREV(input, prev, 1);
+  __m256i b1_high = _mm256_shuffle_epi8(b1_high_lut, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), lo4));
+  __m256i b1_low = _mm256_shuffle_epi8(b1_low_lut, _mm256_and_si256(prev1, lo4));
+  __m256i b2_high = _mm256_shuffle_epi8(b2_high_lut, _mm256_and_si256(_mm256_srli_epi16(input, 4), lo4));
+  __m256i special = _mm256_and_si256(_mm256_and_si256(b1_high, b1_low), b2_high);
+
+  /* 3e / 4e octet d'une séquence: bit 7 attendu exactement là (TWO_CONTS). */
+  __m256i prev2 = RT_PREV(input, prev, 2);
+  __m256i prev3 = RT_PREV(input, prev, 3);
+  __m256i third = _mm256_subs_epu8(prev2, _mm256_set1_epi8((char)(0xE0 - 0x80)));
+  __m256i fourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8((char)(0xF0 - 0x80)));
+  __m256i must23 = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8((char)0x80));
+  return _mm256_xor_si256(must23, special);
+}
+
+RT_TARGET_AVX2 uint32_t rt_utf8_validate_avx2(uintptr_t ptr, size_t n) {
+  const uint8_t *p = (const uint8_t *)ptr;
+  __m256i prev = _mm256_setzero_si256();
+  __m256i err = _mm256_setzero_si256();
+  int prev_ascii = 1;
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    __m256i input = _mm256_loadu_si256((const __m256i *)(p + i));
+    int ascii = _mm256_movemask_epi8(input) == 0;
+    /* Bloc ASCII après un bloc ASCII: rien ne peut être ouvert. */
+    if (!(ascii && prev_ascii)) {
+      err = _mm256_or_si256(err, rt_u8_check(input, prev));
+    }
+    prev = input;
+    prev_ascii = ascii;
+  }
+  /* Queue (0..31 o) + zéros: ferme aussi une séquence ouverte en fin. */
+  uint8_t tail[32];
+  memset(tail, 0, sizeof(tail));
+  if (n > i) {
+    memcpy(tail, p + i, n - i);
+  }
+  __m256i last = _mm256_loadu_si256((const __m256i *)tail);
+  err = _mm256_or_si256(err, rt_u8_check(last, prev));
+  return _mm256_testz_si256(err, err) ? 1u : 0u;
+}
+
+RT_TARGET_AVX2 void rt_hash_stripes_avx2(uintptr_t acc_p, uintptr_t p, size_t stripes, uintptr_t keys_p) {
+  uint64_t *acc = (uint64_t *)acc_p;
+  const uint8_t *in = (const uint8_t *)p;
+  const uint64_t *keys = (const uint64_t *)keys_p;
+  __m256i a0 = _mm256_loadu_si256((const __m256i *)acc);
+  __m256i a1 = _mm256_loadu_si256((const __m256i *)(acc + 4));
+  const __m256i k0 = _mm256_loadu_si256((const __m256i *)keys);
+  const __m256i k1 = _mm256_loadu_si256((const __m256i *)(keys + 4));
+  for (size_t s = 0; s < stripes; s++) {
+    const uint8_t *b = in + s * RT_STRIPE;
+    __m256i d0 = _mm256_loadu_si256((const __m256i *)b);
+    __m256i d1 = _mm256_loadu_si256((const __m256i *)(b + 32));
+    __m256i dk0 = _mm256_xor_si256(d0, k0);
+    __m256i dk1 = _mm256_xor_si256(d1, k1);
+    __m256i p0 = _mm256_mul_epu32(dk0, _mm256_srli_epi64(dk0, 32));
+    __m256i p1 = _mm256_mul_epu32(dk1, _mm256_srli_epi64(dk1, 32));
+    /* Échange dans chaque paire de voies (reste dans la moitié 128 bits). */
+    __m256i s0 = _mm256_shuffle_epi32(d0, _MM_SHUFFLE(1, 0, 3, 2));
+    __m256i s1 = _mm256_shuffle_epi32(d1, _MM_SHUFFLE(1, 0, 3, 2));
+    a0 = _mm256_add_epi64(a0, _mm256_add_epi64(p0, s0));
+    a1 = _mm256_add_epi64(a1, _mm256_add_epi64(p1, s1));
+  }
+  _mm256_storeu_si256((__m256i *)acc, a0);
+  _mm256_storeu_si256((__m256i *)(acc + 4), a1);
+}
+
+#else /* !RT_SIMD_X86 */
+
+/* ----------------------------------------------------------------------------
+ * Autres architectures: symboles présents, jamais choisis par le dispatch
+ * ----------------------------------------------------------------------------
+ */
+
+/* Reprend à i (quelconque), jusqu'à la fin. */
+static uint32_t rt_utf8_scalar_from(const uint8_t *p, size_t n, size_t i) {
+  while (i < n) {
+    if (p[i] < 0x80) {
+      i++;
+      continue;
+    }
+    size_t k = rt_utf8_seq(p, n, i);
+    if (k == 0) {
+      return 0;
+    }
+    i += k;
+  }
+  return 1;
+}
+
+static uint64_t rt_load64(const uint8_t *p) {
+  uint64_t v;
+  memcpy(&v, p, 8);
+  return v;
+}
+
+/* Miroir de abi_stable_hash._stripes_scalar. */
+static void rt_hash_stripes_scalar(uint64_t *acc, const uint8_t *p, size_t stripes, const uint64_t *keys) {
+  for (size_t s = 0; s < stripes; s++) {
+    const uint8_t *b = p + s * RT_STRIPE;
+    for (size_t i = 0; i < 8; i++) {
+      uint64_t d = rt_load64(b + 8 * i);
+      uint64_t dk = d ^ keys[i];
+      acc[i ^ 1] += d;
+      acc[i] += (dk & 0xFFFFFFFFu) * (dk >> 32);
+    }
+  }
+}
+
+uint32_t rt_utf8_validate_sse2(uintptr_t ptr, size_t n) {
+  return rt_utf8_scalar_from((const uint8_t *)ptr, n, 0);
+}
+
+uint32_t rt_utf8_validate_avx2(uintptr_t ptr, size_t n) {
+  return rt_utf8_scalar_from((const uint8_t *)ptr, n, 0);
+}
+
+void rt_hash_stripes_sse2(uintptr_t acc, uintptr_t p, size_t stripes, uintptr_t keys) {
+  rt_hash_stripes_scalar((uint64_t *)acc, (const uint8_t *)p, stripes, (const uint64_t *)keys);
+}
+
+void rt_hash_stripes_avx2(uintptr_t acc, uintptr_t p, size_t stripes, uintptr_t keys) {
+  rt_hash_stripes_scalar((uint64_t *)acc, (const uint8_t *)p, stripes, (const uint64_t *)keys);
+}
+
+#endif /* RT_SIMD_X86 */